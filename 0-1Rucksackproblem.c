@@ -3,11 +3,21 @@
 #include <time.h>
 #include <string.h>  // 用于 memcpy
 #include <stdbool.h> // 用于 bool 类型
+#include <limits.h>
+#include <errno.h>
+#include <stdint.h>
+#include <unistd.h>    // sysconf，用于确定生成线程数
+#include <pthread.h>   // 组合求解的并行引擎与并行数据生成
+#include <stdatomic.h> // 引擎间共享上下界与取消标志
 
 // --- 算法限制常量 ---
 #define MAX_N_FOR_BRUTEFORCE 31
 #define MAX_N_FOR_BACKTRACKING 31
 // #define MAX_NC_FOR_DP 200000000 // DP skip condition removed as per request
+#define MAX_BYTES_FOR_PORTFOLIO_DP (1LL << 30)                 // 组合求解中DP一维数组的内存上限，超出则不启动DP
+#define MAX_BYTES_FOR_PORTFOLIO_DP_TRACE (256LL * 1024 * 1024) // 组合求解中DP记录选择位表的内存上限，超出则分治回溯
+#define PORTFOLIO_POLL_INTERVAL 4096                          // 分支限界每扩展多少个节点检查一次取消标志
+#define PORTFOLIO_TIME_LIMIT_SECONDS 60                       // 组合求解每个实例的时限，超时则取消所有引擎并报告当前上下界
 
 // --- 特殊返回值，表示执行时间状态 ---
 #define TIME_SKIPPED -1.0
@@ -34,11 +44,12 @@ int g_best_weight_bruteforce = 0;
 int g_best_item_count_bruteforce = 0;
 
 // --- 用于存储所有运行的时间信息 ---
+#define NUM_ALGOS 5
 typedef struct
 {
   int n;
   int c;
-  double times[4]; // 0: BF, 1: DP, 2: Greedy, 3: BT
+  double times[NUM_ALGOS]; // 0: BF, 1: DP, 2: Greedy, 3: BT, 4: Portfolio
 } TimingInfo;
 TimingInfo *all_timing_data = NULL;
 int timing_data_count = 0;
@@ -245,6 +256,14 @@ double solve_dp(Item *items, int n, int capacity)
 }
 
 // --- 3. 贪心算法 ---
+// 价值/重量比；重量为0的物品排在最前 (价值也为0时排在最后)
+double item_ratio(const Item *item)
+{
+  if (item->weight > 0)
+    return (double)item->value / item->weight;
+  return item->value > 0 ? 1e9 : 0;
+}
+
 int compareItems(const void *a, const void *b)
 {
   Item *itemA = (Item *)a;
@@ -269,12 +288,7 @@ double solve_greedy(Item *original_items, int n, int capacity)
   memcpy(items_copy, original_items, n * sizeof(Item));
 
   for (int i = 0; i < n; i++)
-  {
-    if (items_copy[i].weight > 0)
-      items_copy[i].ratio = (double)items_copy[i].value / items_copy[i].weight;
-    else
-      items_copy[i].ratio = items_copy[i].value > 0 ? 1e9 : 0; // Handle weight 0 items
-  }
+    items_copy[i].ratio = item_ratio(&items_copy[i]);
   qsort(items_copy, n, sizeof(Item), compareItems);
 
   clock_t start_time = clock();
@@ -424,8 +438,683 @@ double solve_backtracking(Item *items, int n, int capacity)
   return time_taken;
 }
 
-// --- 数据生成 ---
-Item *generate_items(int n)
+// --- 5. 组合求解 (并行执行各精确引擎，先证明最优者胜出) ---
+enum
+{
+  ENGINE_GREEDY_LP, // 贪心下界与LP上界 (启动线程前在主线程计算)
+  ENGINE_DP,
+  ENGINE_BNB,
+  NUM_ENGINES
+};
+const char *engine_names[NUM_ENGINES] = {"贪心/LP界", "动态规划", "分支限界"};
+
+// 各引擎共享的实例数据、上下界和当前最优解
+typedef struct
+{
+  Item *items;
+  int n;
+  int capacity;
+  int *order;                // 按价值/重量比降序排列的原始下标
+  long long *prefix_weight;  // order 顺序下的重量前缀和，长度 n+1
+  long long *prefix_value;   // order 顺序下的价值前缀和，长度 n+1
+  atomic_int lower_bound;    // 已知可行解的最大价值，与 best_selection 同步更新
+  atomic_int upper_bound;    // 已证明的最优值上界
+  atomic_bool done;          // 上下界已相遇或已超时，其余引擎应尽快退出
+  pthread_mutex_t lock;      // 保护以下字段及上下界的更新
+  pthread_cond_t engine_exited;
+  int engines_running;
+  bool timed_out;
+  int winner;
+  int *best_selection;
+  int best_count;
+  int best_weight;
+} PortfolioShared;
+
+// 对指向物品的指针排序，比较规则与 compareItems 相同
+int compareItemPointers(const void *a, const void *b)
+{
+  return compareItems(*(Item *const *)a, *(Item *const *)b);
+}
+
+// 须在持有 lock 时调用：上下界相遇即宣告最优，并记录促成这一点的引擎
+void portfolio_check_closed_locked(PortfolioShared *ps, int engine)
+{
+  if (!atomic_load(&ps->done) && atomic_load(&ps->lower_bound) >= atomic_load(&ps->upper_bound))
+  {
+    ps->winner = engine;
+    atomic_store(&ps->done, true);
+  }
+}
+
+void portfolio_offer_solution(PortfolioShared *ps, int engine, int value, int weight, const int *selection, int count)
+{
+  if (value <= atomic_load(&ps->lower_bound))
+    return;
+  pthread_mutex_lock(&ps->lock);
+  if (value > atomic_load(&ps->lower_bound))
+  {
+    memcpy(ps->best_selection, selection, count * sizeof(int));
+    ps->best_count = count;
+    ps->best_weight = weight;
+    atomic_store(&ps->lower_bound, value);
+    portfolio_check_closed_locked(ps, engine);
+  }
+  pthread_mutex_unlock(&ps->lock);
+}
+
+void portfolio_tighten_upper_bound(PortfolioShared *ps, int engine, int bound)
+{
+  pthread_mutex_lock(&ps->lock);
+  if (bound < atomic_load(&ps->upper_bound))
+    atomic_store(&ps->upper_bound, bound);
+  portfolio_check_closed_locked(ps, engine);
+  pthread_mutex_unlock(&ps->lock);
+}
+
+bool portfolio_cancelled(PortfolioShared *ps)
+{
+  return atomic_load_explicit(&ps->done, memory_order_relaxed);
+}
+
+// Dantzig 上界：从 order 中第 k 个物品起按比值装入剩余容量，临界物品按比例计入
+long long portfolio_lp_bound(const PortfolioShared *ps, int k, long long remaining)
+{
+  long long base = ps->prefix_weight[k];
+  int lo = k, hi = ps->n;
+  while (lo < hi) // 找最大的 j 使 order[k..j) 能全部装入
+  {
+    int mid = lo + (hi - lo + 1) / 2;
+    if (ps->prefix_weight[mid] - base <= remaining)
+      lo = mid;
+    else
+      hi = mid - 1;
+  }
+  long long bound = ps->prefix_value[lo] - ps->prefix_value[k];
+  if (lo < ps->n)
+  {
+    Item *critical = &ps->items[ps->order[lo]]; // 装不下说明其重量必然大于0
+    bound += (remaining - (ps->prefix_weight[lo] - base)) * critical->value / critical->weight;
+  }
+  return bound;
+}
+
+// 对 items[lo, hi) 做一维DP，best[w] 为重量不超过 w 时的最大价值；被取消时返回 false
+bool portfolio_dp_values(PortfolioShared *ps, int lo, int hi, int capacity, int *best)
+{
+  for (int i = lo; i < hi; i++)
+  {
+    if (portfolio_cancelled(ps))
+      return false;
+    int wi = ps->items[i].weight;
+    int vi = ps->items[i].value;
+    for (int w = capacity; w >= wi; w--)
+    {
+      if (best[w - wi] + vi > best[w])
+        best[w] = best[w - wi] + vi;
+    }
+  }
+  return true;
+}
+
+// 对 items[lo, hi) 做一维DP并按位记录每个物品的取舍，回溯出的原始下标追加到 selection
+bool portfolio_dp_trace(PortfolioShared *ps, int lo, int hi, int capacity, int *selection, int *count)
+{
+  size_t row_bytes = ((size_t)capacity + 8) / 8;
+  int *best = (int *)calloc((size_t)capacity + 1, sizeof(int));
+  unsigned char *keep = (unsigned char *)calloc(row_bytes * (hi - lo), 1);
+  if (!best || !keep)
+  {
+    perror("组合求解：为DP回溯表分配内存失败");
+    free(best);
+    free(keep);
+    return false;
+  }
+
+  bool cancelled = false;
+  for (int i = lo; i < hi; i++)
+  {
+    if (portfolio_cancelled(ps))
+    {
+      cancelled = true;
+      break;
+    }
+    int wi = ps->items[i].weight;
+    int vi = ps->items[i].value;
+    unsigned char *row = keep + (size_t)(i - lo) * row_bytes;
+    for (int w = capacity; w >= wi; w--)
+    {
+      if (best[w - wi] + vi > best[w])
+      {
+        best[w] = best[w - wi] + vi;
+        row[w >> 3] |= (unsigned char)(1u << (w & 7));
+      }
+    }
+  }
+
+  if (!cancelled)
+  {
+    int w = capacity;
+    for (int i = hi - 1; i >= lo; i--)
+    {
+      if (keep[(size_t)(i - lo) * row_bytes + (w >> 3)] & (1u << (w & 7)))
+      {
+        selection[(*count)++] = i;
+        w -= ps->items[i].weight;
+      }
+    }
+  }
+  free(keep);
+  free(best);
+  return !cancelled;
+}
+
+// Hirschberg 式分治：前后两半各做一次一维DP，找到最优的容量划分后分别递归，
+// 只需 O(C) 内存即可回溯出选择；子问题的位表不超过 MAX_BYTES_FOR_PORTFOLIO_DP_TRACE 时直接回溯。
+// publish_bound 为真时，一旦求得 items[lo, hi) 的最优值就立即作为上界公布
+bool portfolio_dp_reconstruct(PortfolioShared *ps, int lo, int hi, int capacity, int *selection, int *count,
+                              bool publish_bound)
+{
+  if (hi - lo <= 1 || (long long)(((size_t)capacity + 8) / 8) * (hi - lo) <= MAX_BYTES_FOR_PORTFOLIO_DP_TRACE)
+    return portfolio_dp_trace(ps, lo, hi, capacity, selection, count);
+
+  int mid = lo + (hi - lo) / 2;
+  int *front = (int *)calloc((size_t)capacity + 1, sizeof(int));
+  int *back = (int *)calloc((size_t)capacity + 1, sizeof(int));
+  if (!front || !back)
+  {
+    perror("组合求解：为DP数组分配内存失败");
+    free(front);
+    free(back);
+    return false;
+  }
+  bool finished = portfolio_dp_values(ps, lo, mid, capacity, front) &&
+                  portfolio_dp_values(ps, mid, hi, capacity, back);
+  int split = 0;
+  int optimum = -1;
+  for (int w = 0; finished && w <= capacity; w++)
+  {
+    if (front[w] + back[capacity - w] > optimum)
+    {
+      optimum = front[w] + back[capacity - w];
+      split = w;
+    }
+  }
+  free(front);
+  free(back);
+  if (!finished)
+    return false;
+
+  if (publish_bound)
+    portfolio_tighten_upper_bound(ps, ENGINE_DP, optimum);
+  return portfolio_dp_reconstruct(ps, lo, mid, split, selection, count, false) &&
+         portfolio_dp_reconstruct(ps, mid, hi, capacity - split, selection, count, false);
+}
+
+// 一维DP；先公布最优值作为上界，再回溯出选择作为可行解提交
+void *portfolio_dp_engine(void *arg)
+{
+  PortfolioShared *ps = (PortfolioShared *)arg;
+  int *selection = (int *)malloc(ps->n * sizeof(int));
+  if (!selection)
+  {
+    perror("组合求解：为DP选中物品列表分配内存失败");
+    return NULL;
+  }
+  int count = 0;
+  if (portfolio_dp_reconstruct(ps, 0, ps->n, ps->capacity, selection, &count, true))
+  {
+    int value = 0, weight = 0;
+    for (int i = 0; i < count; i++)
+    {
+      value += ps->items[selection[i]].value;
+      weight += ps->items[selection[i]].weight;
+    }
+    portfolio_offer_solution(ps, ENGINE_DP, value, weight, selection, count);
+    portfolio_tighten_upper_bound(ps, ENGINE_DP, value);
+  }
+  free(selection);
+  return NULL;
+}
+
+// 按比值顺序的深度优先分支限界，用共享下界剪枝；迭代实现以免大N时栈溢出
+void *portfolio_bnb_engine(void *arg)
+{
+  PortfolioShared *ps = (PortfolioShared *)arg;
+  int n = ps->n;
+  bool *taken = (bool *)malloc(n * sizeof(bool)); // order 顺序下的当前取舍
+  int *selection = (int *)malloc(n * sizeof(int));
+  if (!taken || !selection)
+  {
+    perror("组合求解：为分支限界分配内存失败");
+    free(taken);
+    free(selection);
+    return NULL;
+  }
+
+  long long current_weight = 0, current_value = 0;
+  long long nodes = 0;
+  int k = 0;
+  bool exhausted = false;
+  for (;;)
+  {
+    if (++nodes % PORTFOLIO_POLL_INTERVAL == 0 && portfolio_cancelled(ps))
+      break;
+
+    bool backtrack;
+    if (k == n)
+    {
+      if (current_value > atomic_load_explicit(&ps->lower_bound, memory_order_relaxed))
+      {
+        int count = 0;
+        for (int i = 0; i < n; ++i)
+        {
+          if (taken[i])
+            selection[count++] = ps->order[i];
+        }
+        portfolio_offer_solution(ps, ENGINE_BNB, (int)current_value, (int)current_weight, selection, count);
+      }
+      backtrack = true;
+    }
+    else
+    {
+      backtrack = current_value + portfolio_lp_bound(ps, k, ps->capacity - current_weight) <=
+                  atomic_load_explicit(&ps->lower_bound, memory_order_relaxed);
+    }
+
+    if (!backtrack)
+    {
+      // 先尝试装入 order[k]
+      Item *item = &ps->items[ps->order[k]];
+      taken[k] = current_weight + item->weight <= ps->capacity;
+      if (taken[k])
+      {
+        current_weight += item->weight;
+        current_value += item->value;
+      }
+      k++;
+      continue;
+    }
+
+    // 回退到最近一个装入的物品，改为不装入
+    while (k > 0 && !taken[k - 1])
+      k--;
+    if (k == 0)
+    {
+      exhausted = true;
+      break;
+    }
+    Item *item = &ps->items[ps->order[k - 1]];
+    taken[k - 1] = false;
+    current_weight -= item->weight;
+    current_value -= item->value;
+  }
+
+  // 搜索树已穷尽：共享下界即为最优值
+  if (exhausted)
+    portfolio_tighten_upper_bound(ps, ENGINE_BNB, atomic_load(&ps->lower_bound));
+
+  free(selection);
+  free(taken);
+  return NULL;
+}
+
+typedef struct
+{
+  PortfolioShared *ps;
+  void *(*run)(void *);
+} PortfolioLaunch;
+
+// 运行一个引擎，结束时通知 solve_portfolio 中等待时限的主线程
+void *portfolio_engine_thread(void *arg)
+{
+  PortfolioLaunch *launch = (PortfolioLaunch *)arg;
+  PortfolioShared *ps = launch->ps;
+  launch->run(ps);
+  pthread_mutex_lock(&ps->lock);
+  ps->engines_running--;
+  pthread_cond_signal(&ps->engine_exited);
+  pthread_mutex_unlock(&ps->lock);
+  return NULL;
+}
+
+void free_portfolio_shared(PortfolioShared *ps)
+{
+  free(ps->order);
+  free(ps->prefix_weight);
+  free(ps->prefix_value);
+  free(ps->best_selection);
+}
+
+// 返回墙钟时间 (毫秒，含排序和贪心/LP界的准备)：各引擎并行运行，clock() 会累加所有线程的CPU时间
+double solve_portfolio(Item *items, int n, int capacity)
+{
+  const char *method_name = "组合求解";
+  struct timespec start_time, end_time;
+  clock_gettime(CLOCK_MONOTONIC, &start_time);
+
+  PortfolioShared ps = {0};
+  ps.items = items;
+  ps.n = n;
+  ps.capacity = capacity;
+  ps.order = (int *)malloc(n * sizeof(int));
+  ps.prefix_weight = (long long *)malloc((n + 1) * sizeof(long long));
+  ps.prefix_value = (long long *)malloc((n + 1) * sizeof(long long));
+  ps.best_selection = (int *)malloc(n * sizeof(int));
+  // 在副本上计算比值再按指针排序，指针与副本首地址之差即原始下标
+  Item *ranked = (Item *)malloc(n * sizeof(Item));
+  Item **ranked_ptrs = (Item **)malloc(n * sizeof(Item *));
+  if (!ps.order || !ps.prefix_weight || !ps.prefix_value || !ps.best_selection || !ranked || !ranked_ptrs)
+  {
+    perror("为组合求解分配内存失败");
+    free(ranked);
+    free(ranked_ptrs);
+    free_portfolio_shared(&ps);
+    print_solution_details(method_name, items, n, NULL, -1, 0, 0);
+    return TIME_ERROR;
+  }
+
+  memcpy(ranked, items, n * sizeof(Item));
+  for (int i = 0; i < n; i++)
+  {
+    ranked[i].ratio = item_ratio(&ranked[i]);
+    ranked_ptrs[i] = &ranked[i];
+  }
+  qsort(ranked_ptrs, n, sizeof(Item *), compareItemPointers);
+  ps.prefix_weight[0] = 0;
+  ps.prefix_value[0] = 0;
+  for (int i = 0; i < n; i++)
+  {
+    ps.order[i] = (int)(ranked_ptrs[i] - ranked);
+    ps.prefix_weight[i + 1] = ps.prefix_weight[i] + ranked_ptrs[i]->weight;
+    ps.prefix_value[i + 1] = ps.prefix_value[i] + ranked_ptrs[i]->value;
+  }
+  free(ranked_ptrs);
+  free(ranked);
+
+  atomic_init(&ps.lower_bound, 0);
+  atomic_init(&ps.upper_bound, INT_MAX);
+  atomic_init(&ps.done, false);
+  pthread_mutex_init(&ps.lock, NULL);
+  pthread_cond_init(&ps.engine_exited, NULL);
+  ps.winner = -1;
+
+  // 贪心解作为初始下界，LP松弛作为初始上界；二者相等时无需启动任何引擎
+  int greedy_weight = 0, greedy_value = 0, greedy_count = 0;
+  int *greedy_selection = ps.best_selection; // 尚无其他引擎，可直接写入
+  for (int i = 0; i < n; i++)
+  {
+    Item *item = &items[ps.order[i]];
+    if (greedy_weight + item->weight <= capacity)
+    {
+      greedy_weight += item->weight;
+      greedy_value += item->value;
+      greedy_selection[greedy_count++] = ps.order[i];
+    }
+  }
+  ps.best_count = greedy_count;
+  ps.best_weight = greedy_weight;
+  atomic_store(&ps.lower_bound, greedy_value);
+  long long lp_bound = portfolio_lp_bound(&ps, 0, capacity);
+  portfolio_tighten_upper_bound(&ps, ENGINE_GREEDY_LP, lp_bound < INT_MAX ? (int)lp_bound : INT_MAX);
+
+  void *(*engines[NUM_ENGINES])(void *) = {NULL, portfolio_dp_engine, portfolio_bnb_engine};
+  // DP 分治时同时持有前后两个一维数组
+  bool applicable[NUM_ENGINES] = {false, 2 * ((long long)capacity + 1) * (long long)sizeof(int) <= MAX_BYTES_FOR_PORTFOLIO_DP, true};
+  pthread_t threads[NUM_ENGINES];
+  PortfolioLaunch launches[NUM_ENGINES];
+  bool launched[NUM_ENGINES] = {false};
+  for (int e = 0; e < NUM_ENGINES && !portfolio_cancelled(&ps); e++)
+  {
+    if (!applicable[e])
+      continue;
+    launches[e].ps = &ps;
+    launches[e].run = engines[e];
+    pthread_mutex_lock(&ps.lock);
+    ps.engines_running++;
+    pthread_mutex_unlock(&ps.lock);
+    if (pthread_create(&threads[e], NULL, portfolio_engine_thread, &launches[e]) == 0)
+    {
+      launched[e] = true;
+    }
+    else
+    {
+      fprintf(stderr, "组合求解：无法启动 %s 线程\n", engine_names[e]);
+      pthread_mutex_lock(&ps.lock);
+      ps.engines_running--;
+      pthread_mutex_unlock(&ps.lock);
+    }
+  }
+
+  // 等待所有引擎结束；超过时限则置 done 让各引擎在下次检查时退出
+  struct timespec deadline;
+  clock_gettime(CLOCK_REALTIME, &deadline);
+  deadline.tv_sec += PORTFOLIO_TIME_LIMIT_SECONDS;
+  pthread_mutex_lock(&ps.lock);
+  while (ps.engines_running > 0 && !ps.timed_out)
+  {
+    if (pthread_cond_timedwait(&ps.engine_exited, &ps.lock, &deadline) == ETIMEDOUT && ps.engines_running > 0)
+    {
+      ps.timed_out = true;
+      atomic_store(&ps.done, true);
+    }
+  }
+  pthread_mutex_unlock(&ps.lock);
+  for (int e = 0; e < NUM_ENGINES; e++)
+  {
+    if (launched[e])
+      pthread_join(threads[e], NULL);
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &end_time);
+  double time_taken = (end_time.tv_sec - start_time.tv_sec) * 1000.0 +
+                      (end_time.tv_nsec - start_time.tv_nsec) / 1000000.0;
+
+  char title[128];
+  if (ps.winner >= 0)
+    snprintf(title, sizeof(title), "%s (最优，胜出: %s)", method_name, engine_names[ps.winner]);
+  else if (ps.timed_out)
+    snprintf(title, sizeof(title), "%s (超时 %d 秒，未能证明最优，上界 %d)", method_name, PORTFOLIO_TIME_LIMIT_SECONDS, atomic_load(&ps.upper_bound));
+  else
+    snprintf(title, sizeof(title), "%s (未能证明最优，上界 %d)", method_name, atomic_load(&ps.upper_bound));
+  print_solution_details(title, items, n, ps.best_selection, ps.best_count, atomic_load(&ps.lower_bound), ps.best_weight);
+
+  pthread_cond_destroy(&ps.engine_exited);
+  pthread_mutex_destroy(&ps.lock);
+  free_portfolio_shared(&ps);
+  return time_taken;
+}
+
+// --- 数据生成 (Pisinger 实例类型，计数器型随机数发生器) ---
+// 第 i 个物品只由 (种子, i) 决定，因此可以分块并行生成，且结果与线程数和平台无关
+#define GENERATOR_DEFAULT_RANGE 1000         // Pisinger 类实例的默认数据范围 R，可用 --range 修改
+#define GENERATOR_MAX_RANGE 10000000         // R 的上限 (Pisinger 的测试取 10^3 ~ 10^7)
+#define SPANNER_SET_SIZE 2                   // spanner(v, m) 中的 v
+#define SPANNER_MULTIPLIER_MAX 10            // spanner(v, m) 中的 m
+#define GENERATOR_MIN_ITEMS_PER_THREAD 65536 // 每个生成线程至少负责的物品数
+#define GENERATOR_MAX_THREADS 64
+
+typedef enum
+{
+  INSTANCE_LEGACY, // 原程序的分布：重量 [1, 100]，价值 [100, 1000]，容量取固定值
+  INSTANCE_UNCORRELATED,
+  INSTANCE_WEAKLY_CORRELATED,
+  INSTANCE_STRONGLY_CORRELATED,
+  INSTANCE_INVERSE_STRONGLY_CORRELATED,
+  INSTANCE_SUBSET_SUM,
+  INSTANCE_SPANNER,
+  NUM_INSTANCE_CLASSES
+} InstanceClass;
+const char *instance_class_options[NUM_INSTANCE_CLASSES] = {"legacy", "uncorrelated", "weak", "strong", "inverse-strong", "subset-sum", "spanner"};
+const char *instance_class_names[NUM_INSTANCE_CLASSES] = {"原始分布", "不相关", "弱相关", "强相关", "逆强相关", "子集和", "spanner(2,10) 强相关"};
+
+// 计数器流：同一种子下物品和 spanner 集合使用互不重叠的随机数
+enum
+{
+  RNG_STREAM_ITEMS,
+  RNG_STREAM_SPANNER_SET
+};
+
+// Philox4x32-10 (Salmon et al., SC'11)：对 128 位计数器做 10 轮乘法-异或混合
+void philox4x32_10(const uint32_t counter[4], const uint32_t key[2], uint32_t out[4])
+{
+  uint32_t c0 = counter[0], c1 = counter[1], c2 = counter[2], c3 = counter[3];
+  uint32_t k0 = key[0], k1 = key[1];
+  for (int round = 0; round < 10; round++)
+  {
+    uint64_t p0 = (uint64_t)0xD2511F53u * c0;
+    uint64_t p1 = (uint64_t)0xCD9E8D57u * c2;
+    c0 = (uint32_t)(p1 >> 32) ^ c1 ^ k0;
+    c1 = (uint32_t)p1;
+    c2 = (uint32_t)(p0 >> 32) ^ c3 ^ k1;
+    c3 = (uint32_t)p0;
+    k0 += 0x9E3779B9u;
+    k1 += 0xBB67AE85u;
+  }
+  out[0] = c0;
+  out[1] = c1;
+  out[2] = c2;
+  out[3] = c3;
+}
+
+void philox_draw(uint64_t seed, int stream, int index, uint32_t out[4])
+{
+  uint32_t counter[4] = {(uint32_t)index, 0, (uint32_t)stream, 0};
+  uint32_t key[2] = {(uint32_t)seed, (uint32_t)(seed >> 32)};
+  philox4x32_10(counter, key, out);
+}
+
+// 把 32 位随机数映射到 [lo, hi]，用乘法取高位代替取模
+int uniform_in_range(uint32_t r, int lo, int hi)
+{
+  return lo + (int)(((uint64_t)r * (uint32_t)(hi - lo + 1)) >> 32);
+}
+
+// 按 Pisinger 的定义生成一个 (重量, 价值) 对；r 为该物品的 4 个随机数，range 为数据范围 R
+void generate_pair(InstanceClass instance_class, int range, const uint32_t r[4], int *weight, int *value)
+{
+  switch (instance_class)
+  {
+  case INSTANCE_LEGACY: // 与原先的 rand() 版本保持相同的取值范围
+    *weight = uniform_in_range(r[0], 1, 100);
+    *value = uniform_in_range(r[1], 100, 1000);
+    break;
+  case INSTANCE_UNCORRELATED:
+    *weight = uniform_in_range(r[0], 1, range);
+    *value = uniform_in_range(r[1], 1, range);
+    break;
+  case INSTANCE_WEAKLY_CORRELATED:
+    *weight = uniform_in_range(r[0], 1, range);
+    *value = uniform_in_range(r[1], *weight - range / 10, *weight + range / 10);
+    if (*value < 1)
+      *value = 1;
+    break;
+  case INSTANCE_STRONGLY_CORRELATED:
+  case INSTANCE_SPANNER: // spanner 集合本身取强相关
+    *weight = uniform_in_range(r[0], 1, range);
+    *value = *weight + range / 10;
+    break;
+  case INSTANCE_INVERSE_STRONGLY_CORRELATED:
+    *value = uniform_in_range(r[1], 1, range);
+    *weight = *value + range / 10;
+    break;
+  case INSTANCE_SUBSET_SUM:
+    *weight = uniform_in_range(r[0], 1, range);
+    *value = *weight;
+    break;
+  default:
+    *weight = 1;
+    *value = 1;
+    break;
+  }
+}
+
+typedef struct
+{
+  Item *items;
+  int begin;
+  int end;
+  InstanceClass instance_class;
+  int range;
+  uint64_t seed;
+  const Item *spanner_set;
+} GeneratorChunk;
+
+void *generate_chunk(void *arg)
+{
+  GeneratorChunk *chunk = (GeneratorChunk *)arg;
+  for (int i = chunk->begin; i < chunk->end; i++)
+  {
+    uint32_t r[4];
+    philox_draw(chunk->seed, RNG_STREAM_ITEMS, i, r);
+    Item *item = &chunk->items[i];
+    item->id = i + 1; // Assign unique ID
+    item->ratio = 0;
+    if (chunk->instance_class == INSTANCE_SPANNER)
+    {
+      // 随机取一个 spanner 物品并乘以 [1, m] 中的倍数
+      const Item *spanner = &chunk->spanner_set[uniform_in_range(r[2], 0, SPANNER_SET_SIZE - 1)];
+      int multiplier = uniform_in_range(r[3], 1, SPANNER_MULTIPLIER_MAX);
+      item->weight = spanner->weight * multiplier;
+      item->value = spanner->value * multiplier;
+    }
+    else
+    {
+      generate_pair(chunk->instance_class, chunk->range, r, &item->weight, &item->value);
+    }
+  }
+  return NULL;
+}
+
+// 用 num_threads 个线程填充 items；输出只取决于 (n, instance_class, range, seed)
+void fill_items(Item *items, int n, InstanceClass instance_class, int range, uint64_t seed, int num_threads)
+{
+  Item spanner_set[SPANNER_SET_SIZE];
+  for (int j = 0; j < SPANNER_SET_SIZE; j++)
+  {
+    uint32_t r[4];
+    philox_draw(seed, RNG_STREAM_SPANNER_SET, j, r);
+    generate_pair(INSTANCE_SPANNER, range, r, &spanner_set[j].weight, &spanner_set[j].value);
+    // Pisinger 的归一化：重量和价值都除以 m+1，且至少为 1
+    spanner_set[j].weight /= SPANNER_MULTIPLIER_MAX + 1;
+    spanner_set[j].value /= SPANNER_MULTIPLIER_MAX + 1;
+    if (spanner_set[j].weight < 1)
+      spanner_set[j].weight = 1;
+    if (spanner_set[j].value < 1)
+      spanner_set[j].value = 1;
+  }
+
+  if (num_threads < 1)
+    num_threads = 1;
+  if (num_threads > GENERATOR_MAX_THREADS)
+    num_threads = GENERATOR_MAX_THREADS;
+  GeneratorChunk chunks[GENERATOR_MAX_THREADS];
+  pthread_t threads[GENERATOR_MAX_THREADS];
+  bool launched[GENERATOR_MAX_THREADS];
+  for (int t = 0; t < num_threads; t++)
+  {
+    chunks[t].items = items;
+    chunks[t].begin = (int)((long long)n * t / num_threads);
+    chunks[t].end = (int)((long long)n * (t + 1) / num_threads);
+    chunks[t].instance_class = instance_class;
+    chunks[t].range = range;
+    chunks[t].seed = seed;
+    chunks[t].spanner_set = spanner_set;
+    // 第 0 块由当前线程生成；创建线程失败时也退回当前线程，结果不受影响
+    launched[t] = t > 0 && pthread_create(&threads[t], NULL, generate_chunk, &chunks[t]) == 0;
+  }
+  for (int t = 0; t < num_threads; t++)
+  {
+    if (!launched[t])
+      generate_chunk(&chunks[t]);
+  }
+  for (int t = 0; t < num_threads; t++)
+  {
+    if (launched[t])
+      pthread_join(threads[t], NULL);
+  }
+}
+
+Item *generate_items(int n, InstanceClass instance_class, int range, uint64_t seed)
 {
   Item *items = (Item *)malloc(n * sizeof(Item));
   if (!items)
@@ -433,14 +1122,29 @@ Item *generate_items(int n)
     perror("物品内存分配失败");
     exit(EXIT_FAILURE);
   }
+  long num_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+  int num_threads = n / GENERATOR_MIN_ITEMS_PER_THREAD;
+  if (num_cpus > 0 && num_threads > num_cpus)
+    num_threads = (int)num_cpus;
+  fill_items(items, n, instance_class, range, seed, num_threads);
+  return items;
+}
+
+// Pisinger 的容量设置：一组 H 个实例中第 h 个取 c = h/(H+1)·Σw，legacy 类沿用固定容量
+// 总重量或总价值超出 int 时返回 -1 (各求解器以 int 累加)
+int instance_capacity(const Item *items, int n, InstanceClass instance_class, int h, int H, int fixed_capacity)
+{
+  long long total_weight = 0, total_value = 0;
   for (int i = 0; i < n; i++)
   {
-    items[i].id = i + 1; // Assign unique ID
-    items[i].weight = rand() % 100 + 1;
-    items[i].value = rand() % 901 + 100;
-    items[i].ratio = 0;
+    total_weight += items[i].weight;
+    total_value += items[i].value;
   }
-  return items;
+  if (total_weight > INT_MAX || total_value > INT_MAX)
+    return -1;
+  if (instance_class == INSTANCE_LEGACY)
+    return fixed_capacity;
+  return (int)(total_weight * h / (H + 1));
 }
 
 // --- 为N=1000的情况输出物品统计信息到控制台并生成CSV文件 ---
@@ -495,7 +1199,7 @@ void output_item_statistics_for_n1000(Item *items, int n, int capacity)
 }
 
 // Helper to add timing data to the global array
-void add_timing_entry(int n, int c, double times_local[4])
+void add_timing_entry(int n, int c, double times_local[NUM_ALGOS])
 {
   if (timing_data_count >= timing_data_capacity)
   {
@@ -512,33 +1216,91 @@ void add_timing_entry(int n, int c, double times_local[4])
   }
   all_timing_data[timing_data_count].n = n;
   all_timing_data[timing_data_count].c = c;
-  memcpy(all_timing_data[timing_data_count].times, times_local, 4 * sizeof(double));
+  memcpy(all_timing_data[timing_data_count].times, times_local, NUM_ALGOS * sizeof(double));
   timing_data_count++;
 }
 
+// 对一个实例运行求解器；组合模式下只运行并行组合求解，其余依次运行，未运行的记为 SKIPPED
+void run_solvers(Item *items, int n, int capacity, bool portfolio_mode, double times_local[NUM_ALGOS])
+{
+  for (int k = 0; k < NUM_ALGOS; ++k)
+    times_local[k] = TIME_SKIPPED;
+  if (portfolio_mode)
+  {
+    times_local[4] = solve_portfolio(items, n, capacity);
+    return;
+  }
+  times_local[0] = solve_bruteforce(items, n, capacity);
+  times_local[1] = solve_dp(items, n, capacity);
+  times_local[2] = solve_greedy(items, n, capacity);
+  times_local[3] = solve_backtracking(items, n, capacity);
+}
+
 // --- 主函数 ---
-int main()
+int main(int argc, char *argv[])
 {
-  srand(time(NULL));
+  bool portfolio_mode = false;
+  InstanceClass instance_class = INSTANCE_LEGACY;
+  int range = GENERATOR_DEFAULT_RANGE;
+  uint64_t seed = (uint64_t)time(NULL);
+  for (int a = 1; a < argc; ++a)
+  {
+    if (strcmp(argv[a], "--portfolio") == 0)
+      portfolio_mode = true;
+    else if (strcmp(argv[a], "--seed") == 0 && a + 1 < argc)
+      seed = strtoull(argv[++a], NULL, 10);
+    else if (strcmp(argv[a], "--range") == 0 && a + 1 < argc)
+    {
+      range = atoi(argv[++a]);
+      if (range < 1 || range > GENERATOR_MAX_RANGE)
+      {
+        fprintf(stderr, "数据范围须在 [1, %d] 内: %s\n", GENERATOR_MAX_RANGE, argv[a]);
+        return EXIT_FAILURE;
+      }
+    }
+    else if (strcmp(argv[a], "--class") == 0 && a + 1 < argc)
+    {
+      const char *option = argv[++a];
+      int k = 0;
+      while (k < NUM_INSTANCE_CLASSES && strcmp(option, instance_class_options[k]) != 0)
+        ++k;
+      if (k == NUM_INSTANCE_CLASSES)
+      {
+        fprintf(stderr, "未知的实例类型: %s\n", option);
+        return EXIT_FAILURE;
+      }
+      instance_class = (InstanceClass)k;
+    }
+    else
+    {
+      fprintf(stderr, "用法: %s [--portfolio] [--class legacy|uncorrelated|weak|strong|inverse-strong|subset-sum|spanner] [--range R] [--seed N]\n", argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+  // 每个实例使用 seed + 实例序号，相同参数重新运行可得到完全相同的数据
+  int instance_index = 0;
+  // 除 legacy 外，容量按 Pisinger 的方式取总重量的 h/(H+1)，见 instance_capacity
+  if (instance_class == INSTANCE_LEGACY)
+    printf("实例类型: %s, 随机种子: %llu\n", instance_class_names[instance_class], (unsigned long long)seed);
+  else
+    printf("实例类型: %s, 数据范围 R = %d, 随机种子: %llu\n", instance_class_names[instance_class], range, (unsigned long long)seed);
 
-  double current_run_times[4]; // 0: BF, 1: DP, 2: Greedy, 3: BT
-  const char *algo_names[] = {"蛮力法", "动态规划", "贪心法", "回溯法"};
+  double current_run_times[NUM_ALGOS]; // 0: BF, 1: DP, 2: Greedy, 3: BT, 4: Portfolio
+  // 组合求解为包含排序、贪心/LP界准备的墙钟时间，其余列为核心循环的CPU时间 (clock())，二者不可直接比较
+  const char *algo_names[] = {"蛮力法", "动态规划", "贪心法", "回溯法", "组合求解(墙钟)"};
 
   // --- 示例测试用例 (N=30) ---
   int n_example = 30;
-  int capacity_example = 1000;
+  Item *items_example = generate_items(n_example, instance_class, range, seed + instance_index++);
+  int capacity_example = instance_capacity(items_example, n_example, instance_class, 1, 1, 1000); // N 很小，不会溢出
   printf("\n\n##########################################\n");
   printf("开始测试: N = %d, 容量 = %d (示例)\n", n_example, capacity_example);
   printf("##########################################\n");
-  Item *items_example = generate_items(n_example);
-  current_run_times[0] = solve_bruteforce(items_example, n_example, capacity_example);
-  current_run_times[1] = solve_dp(items_example, n_example, capacity_example);
-  current_run_times[2] = solve_greedy(items_example, n_example, capacity_example);
-  current_run_times[3] = solve_backtracking(items_example, n_example, capacity_example);
+  run_solvers(items_example, n_example, capacity_example, portfolio_mode, current_run_times);
   add_timing_entry(n_example, capacity_example, current_run_times);
   free(items_example);
   printf("\n--- (N=%d, C=%d) 执行时间摘要 ---\n", n_example, capacity_example);
-  for (int k = 0; k < 4; ++k)
+  for (int k = 0; k < NUM_ALGOS; ++k)
   {
     printf("%-12s 执行时间: ", algo_names[k]);
     if (current_run_times[k] == TIME_SKIPPED)
@@ -553,19 +1315,16 @@ int main()
 
   // --- 特定 N 和 Capacity 的执行时间测试 ---
   int n_specific = 25;
-  int capacity_specific = 800;
+  Item *items_specific_test = generate_items(n_specific, instance_class, range, seed + instance_index++);
+  int capacity_specific = instance_capacity(items_specific_test, n_specific, instance_class, 1, 1, 800);
   printf("\n\n##########################################\n");
   printf("开始测试: N = %d, 容量 = %d (特定测试)\n", n_specific, capacity_specific);
   printf("##########################################\n");
-  Item *items_specific_test = generate_items(n_specific);
-  current_run_times[0] = solve_bruteforce(items_specific_test, n_specific, capacity_specific);
-  current_run_times[1] = solve_dp(items_specific_test, n_specific, capacity_specific);
-  current_run_times[2] = solve_greedy(items_specific_test, n_specific, capacity_specific);
-  current_run_times[3] = solve_backtracking(items_specific_test, n_specific, capacity_specific);
+  run_solvers(items_specific_test, n_specific, capacity_specific, portfolio_mode, current_run_times);
   add_timing_entry(n_specific, capacity_specific, current_run_times);
   free(items_specific_test);
   printf("\n--- (N=%d, C=%d) 执行时间摘要 ---\n", n_specific, capacity_specific);
-  for (int k = 0; k < 4; ++k)
+  for (int k = 0; k < NUM_ALGOS; ++k)
   {
     printf("%-12s 执行时间: ", algo_names[k]);
     if (current_run_times[k] == TIME_SKIPPED)
@@ -580,7 +1339,7 @@ int main()
 
   // --- 指定的输入规模 ---
   int N_values[] = {1000, 2000, 3000, 4000, 5000, 6000, 7000, 8000, 9000, 10000, 20000, 40000, 80000, 160000, 320000};
-  int C_values[] = {10000, 100000, 1000000};
+  int C_values[] = {10000, 100000, 1000000}; // legacy 类的固定容量；其余类取 h/(H+1)·Σw，h = j+1，H = num_C_values
   int num_N_values = sizeof(N_values) / sizeof(N_values[0]);
   int num_C_values = sizeof(C_values) / sizeof(C_values[0]);
 
@@ -589,24 +1348,28 @@ int main()
     int n_loop = N_values[i];
     for (int j = 0; j < num_C_values; j++)
     {
-      int capacity_loop = C_values[j];
+      Item *items_generated = generate_items(n_loop, instance_class, range, seed + instance_index++);
+      int capacity_loop = instance_capacity(items_generated, n_loop, instance_class, j + 1, num_C_values, C_values[j]);
       printf("\n\n##########################################\n");
+      if (capacity_loop < 0)
+      {
+        printf("跳过测试: N = %d, R = %d (总重量或总价值超出 int 范围)\n", n_loop, range);
+        printf("##########################################\n");
+        free(items_generated);
+        continue;
+      }
       printf("开始测试: N = %d, 容量 = %d (循环 %d/%d, %d/%d)\n", n_loop, capacity_loop, i + 1, num_N_values, j + 1, num_C_values);
       printf("##########################################\n");
-      Item *items_generated = generate_items(n_loop);
       if (n_loop == 1000 && j == 0) // j==0 确保只对 N=1000 的第一个C值执行
       {
         output_item_statistics_for_n1000(items_generated, n_loop, capacity_loop);
       }
-      current_run_times[0] = solve_bruteforce(items_generated, n_loop, capacity_loop);
-      current_run_times[1] = solve_dp(items_generated, n_loop, capacity_loop);
-      current_run_times[2] = solve_greedy(items_generated, n_loop, capacity_loop);
-      current_run_times[3] = solve_backtracking(items_generated, n_loop, capacity_loop);
+      run_solvers(items_generated, n_loop, capacity_loop, portfolio_mode, current_run_times);
       add_timing_entry(n_loop, capacity_loop, current_run_times);
       free(items_generated);
 
       printf("\n--- (N=%d, C=%d) 执行时间摘要 ---\n", n_loop, capacity_loop);
-      for (int k = 0; k < 4; ++k)
+      for (int k = 0; k < NUM_ALGOS; ++k)
       {
         printf("%-12s 执行时间: ", algo_names[k]);
         if (current_run_times[k] == TIME_SKIPPED)
@@ -624,10 +1387,10 @@ int main()
   printf("\n\n#################################################################################\n");
   printf("###                         所有测试执行时间总表 (毫秒)                       ###\n");
   printf("#################################################################################\n");
-  printf("| %-8s | %-10s | %-18s | %-18s | %-15s | %-18s |\n", "N", "Capacity", algo_names[0], algo_names[1], algo_names[2], algo_names[3]);
-  printf("|----------|------------|--------------------|--------------------|-----------------|--------------------|\n");
+  printf("| %-8s | %-10s | %-18s | %-18s | %-15s | %-18s | %-18s |\n", "N", "Capacity", algo_names[0], algo_names[1], algo_names[2], algo_names[3], algo_names[4]);
+  printf("|----------|------------|--------------------|--------------------|-----------------|--------------------|--------------------|\n");
 
-  char time_str_bf[20], time_str_dp[20], time_str_greedy[20], time_str_bt[20];
+  char time_str_bf[20], time_str_dp[20], time_str_greedy[20], time_str_bt[20], time_str_pf[20];
 
   for (int i = 0; i < timing_data_count; ++i)
   {
@@ -661,9 +1424,16 @@ int main()
     else
       sprintf(time_str_bt, "%-18.2f", current_data.times[3]);
 
-    printf("| %-8d | %-10d | %s | %s | %s | %s |\n",
+    if (current_data.times[4] == TIME_SKIPPED)
+      sprintf(time_str_pf, "%-18s", "SKIPPED");
+    else if (current_data.times[4] == TIME_ERROR)
+      sprintf(time_str_pf, "%-18s", "ERROR");
+    else
+      sprintf(time_str_pf, "%-18.2f", current_data.times[4]);
+
+    printf("| %-8d | %-10d | %s | %s | %s | %s | %s |\n",
            current_data.n, current_data.c,
-           time_str_bf, time_str_dp, time_str_greedy, time_str_bt);
+           time_str_bf, time_str_dp, time_str_greedy, time_str_bt, time_str_pf);
   }
   printf("#################################################################################\n");
 